@@ -0,0 +1,210 @@
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#if JUCE_LINUX
+ #include <linux/perf_event.h>
+ #include <sys/ioctl.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#endif
+
+//==============================================================================
+// Times SynthPluginAudioProcessor::processBlock over a range of block sizes
+// and splits the cost into a fixed per-block overhead and a per-sample cost
+// (least-squares fit of  ns/block = fixed + perSample × blockSize), fitted
+// separately for low-latency mode (blocks ≤ 64) and standard mode, since the
+// two render and poll parameters differently.
+// Also reports the per-voice memory footprint and, on Linux where
+// perf_event_open is permitted, hardware cache misses per block.
+//
+//   DarkSynthBenchmark [--quick]
+//==============================================================================
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr double kSampleRate   = 48000.0;
+    constexpr int    kBlockSizes[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256, 512 };
+    constexpr int    kNoteCounts[] = { 0, 1, 4, 16 };
+
+    struct Measurement
+    {
+        int    blockSize;
+        double nsPerBlock;
+        bool   lowLatency;
+        double missesPerBlock; // < 0 when unavailable
+    };
+
+    // Counts last-level cache misses of this thread between start() and stop()
+    class CacheMissCounter
+    {
+    public:
+        CacheMissCounter()
+        {
+           #if JUCE_LINUX
+            perf_event_attr attr {};
+            attr.type           = PERF_TYPE_HARDWARE;
+            attr.size           = sizeof (attr);
+            attr.config         = PERF_COUNT_HW_CACHE_MISSES;
+            attr.disabled       = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            fd = (int) syscall (__NR_perf_event_open, &attr, 0, -1, -1, 0);
+           #endif
+        }
+
+        ~CacheMissCounter()
+        {
+           #if JUCE_LINUX
+            if (fd >= 0) close (fd);
+           #endif
+        }
+
+        bool isAvailable() const noexcept { return fd >= 0; }
+
+        void start()
+        {
+           #if JUCE_LINUX
+            if (fd < 0) return;
+            ioctl (fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl (fd, PERF_EVENT_IOC_ENABLE, 0);
+           #endif
+        }
+
+        long long stop()
+        {
+            long long count = -1;
+           #if JUCE_LINUX
+            if (fd < 0) return -1;
+            ioctl (fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read (fd, &count, sizeof (count)) != (ssize_t) sizeof (count))
+                count = -1;
+           #endif
+            return count;
+        }
+
+    private:
+        int fd = -1;
+    };
+
+    // Average wall time of one processBlock call with numNotes held notes
+    Measurement measure (int blockSize, int numNotes, double seconds)
+    {
+        SynthPluginAudioProcessor proc;
+        proc.setPlayConfigDetails (0, 2, kSampleRate, blockSize);
+        proc.prepareToPlay (kSampleRate, blockSize);
+
+        // Full sustain so every note stays active for the whole run
+        if (auto* p = proc.apvts.getParameter ("sustain"))
+            p->setValueNotifyingHost (1.0f);
+
+        juce::AudioBuffer<float> buffer (2, blockSize);
+        juce::MidiBuffer notes, empty;
+        for (int n = 0; n < numNotes; ++n)
+            notes.addEvent (juce::MidiMessage::noteOn (1, 36 + n * 3, 0.8f), 0);
+        proc.processBlock (buffer, notes);
+
+        const int numBlocks = juce::jmax (2000, (int) (seconds * kSampleRate) / blockSize);
+
+        for (int i = 0; i < numBlocks / 10; ++i)
+            proc.processBlock (buffer, empty);
+
+        auto start = Clock::now();
+        for (int i = 0; i < numBlocks; ++i)
+            proc.processBlock (buffer, empty);
+        auto elapsed = std::chrono::duration<double, std::nano> (Clock::now() - start).count();
+
+        // Separate pass so the counter syscalls don't skew the timing
+        CacheMissCounter misses;
+        misses.start();
+        for (int i = 0; i < numBlocks; ++i)
+            proc.processBlock (buffer, empty);
+        auto missCount = misses.stop();
+
+        proc.releaseResources();
+        return { blockSize, elapsed / numBlocks, proc.isLowLatencyMode(),
+                 missCount >= 0 ? (double) missCount / numBlocks : -1.0 };
+    }
+
+    // Fits the points of one mode; false if there are too few to fit a line
+    bool fit (const std::vector<Measurement>& m, bool lowLatency, double& fixed, double& perSample)
+    {
+        double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+        for (auto& r : m)
+        {
+            if (r.lowLatency != lowLatency)
+                continue;
+
+            n   += 1.0;
+            sx  += r.blockSize;
+            sy  += r.nsPerBlock;
+            sxx += (double) r.blockSize * r.blockSize;
+            sxy += r.blockSize * r.nsPerBlock;
+        }
+
+        if (n < 2.0)
+            return false;
+
+        perSample = (n * sxy - sx * sy) / (n * sxx - sx * sx);
+        fixed     = (sy - perSample * sx) / n;
+        return true;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    juce::ArgumentList args (argc, argv);
+
+    const double seconds = args.containsOption ("--quick") ? 0.25 : 2.0;
+
+    std::printf ("DarkSynth processBlock benchmark  (%.0f Hz, stereo, %.2f s audio per point)\n",
+                 kSampleRate, seconds);
+
+    {
+        constexpr int footprintBlock = kBlockSizes[std::size (kBlockSizes) - 1];
+
+        SynthPluginAudioProcessor proc;
+        proc.setPlayConfigDetails (0, 2, kSampleRate, footprintBlock);
+        proc.prepareToPlay (kSampleRate, footprintBlock);
+
+        std::printf ("\nVoice footprint: %d-byte voice arena (%d bytes per voice, %d-byte hot block,\n"
+                     "                 %d-byte alignment) + %d-byte shared scratch at %d-sample blocks\n",
+                     (int) proc.getVoiceArenaBytes(), (int) sizeof (SynthVoice),
+                     (int) sizeof (SynthVoice::HotState), (int) alignof (SynthVoice),
+                     (int) proc.getScratchBytes(), footprintBlock);
+
+        proc.releaseResources();
+    }
+
+    if (! CacheMissCounter().isAvailable())
+        std::printf ("Cache misses:    unavailable (perf_event_open not permitted or unsupported)\n");
+
+    for (int numNotes : kNoteCounts)
+    {
+        std::printf ("\n== %d note%s held ==\n", numNotes, numNotes == 1 ? "" : "s");
+        std::printf ("%8s %14s %14s %6s %16s\n", "block", "ns/block", "ns/sample", "mode", "cache miss/block");
+
+        std::vector<Measurement> results;
+        for (int bs : kBlockSizes)
+        {
+            auto r = measure (bs, numNotes, seconds);
+            results.push_back (r);
+            std::printf ("%8d %14.1f %14.2f %6s %16.2f\n", r.blockSize, r.nsPerBlock,
+                         r.nsPerBlock / r.blockSize, r.lowLatency ? "LL" : "std",
+                         r.missesPerBlock);
+        }
+
+        for (bool lowLatency : { true, false })
+        {
+            double fixed = 0.0, perSample = 0.0;
+            if (fit (results, lowLatency, fixed, perSample))
+                std::printf ("%-13s fixed overhead: %.1f ns/block   per-sample cost: %.2f ns/sample\n",
+                             lowLatency ? "low-latency:" : "standard:", fixed, perSample);
+        }
+    }
+
+    return 0;
+}
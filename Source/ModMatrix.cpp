@@ -0,0 +1,224 @@
+#include "ModMatrix.h"
+
+namespace {
+    // Destination offset produced by a source at full scale with amount = ±1
+    constexpr float kDestinationRange[ModMatrix::numDestinations] = {
+        0.0f,   // None
+        48.0f,  // Cutoff  — semitones above/below the key-tracked centre
+        7.0f,   // Focus   — bandpass Q
+        1.0f,   // Drive
+        1.0f,   // Sub blend
+        12.0f,  // Pitch   — semitones
+        1.0f,   // Volume  — linear gain offset
+    };
+
+    // Bipolar LFO shapes, phase in [0, 1)
+    inline float lfoShape (int shape, float phase) noexcept
+    {
+        switch (shape)
+        {
+            case 1:  return phase < 0.5f ? 4.0f * phase - 1.0f : 3.0f - 4.0f * phase; // Triangle
+            case 2:  return 1.0f - 2.0f * phase;                                      // Saw
+            case 3:  return phase < 0.5f ? 1.0f : -1.0f;                              // Square
+            default: return std::sin (phase * juce::MathConstants<float>::twoPi);     // Sine
+        }
+    }
+
+    inline float wrapPhase (float phase) noexcept
+    {
+        return phase - std::floor (phase);
+    }
+
+    inline bool slotIsActive (const ModParams::Slot& slot) noexcept
+    {
+        return slot.source > ModMatrix::srcNone && slot.source < ModMatrix::numSources
+            && slot.destination > ModMatrix::dstNone && slot.destination < ModMatrix::numDestinations
+            && ! juce::exactlyEqual (slot.amount, 0.0f);
+    }
+}
+
+void ModMatrix::prepare (double newSampleRate, int newNumVoices)
+{
+    jassert (newNumVoices <= maxVoices);
+
+    sampleRate = newSampleRate;
+    numVoices  = juce::jmin (newNumVoices, maxVoices);
+
+    lfo1Phase = 0.0f;
+    lfo1Value = 0.0f;
+    lfo2Phase.fill (0.0f);
+    lfo2Value.fill (0.0f);
+    envLevel.fill (0.0f);
+    envReleaseRate.fill (0.0f);
+    envStage.fill (envIdle);
+
+    for (auto& d : periodStart) d.fill (0.0f);
+    for (auto& d : periodEnd) d.fill (0.0f);
+
+    periodPos = interval; // tick before the first render
+}
+
+void ModMatrix::setParameters (const ModParams& p) noexcept
+{
+    params = p;
+}
+
+//==============================================================================
+void ModMatrix::tick() noexcept
+{
+    interval    = juce::jlimit (1, 4096, params.controlInterval);
+    invInterval = 1.0f / (float) interval;
+    periodPos   = 0;
+    ++tickCount;
+
+    // The previous period's end is this period's start
+    periodStart = periodEnd;
+
+    const float periodSeconds = (float) ((double) interval / sampleRate);
+
+    // Global LFO — one evaluation regardless of voice count
+    lfo1Phase = wrapPhase (lfo1Phase + params.lfo1Rate * periodSeconds);
+    lfo1Value = lfoShape (params.lfo1Shape, lfo1Phase);
+
+    // Per-voice LFOs
+    const float lfo2Inc = params.lfo2Rate * periodSeconds;
+    for (int v = 0; v < numVoices; ++v)
+        lfo2Phase[(size_t) v] = wrapPhase (lfo2Phase[(size_t) v] + lfo2Inc);
+
+    for (int v = 0; v < numVoices; ++v)
+        lfo2Value[(size_t) v] = lfoShape (params.lfo2Shape, lfo2Phase[(size_t) v]);
+
+    advanceEnvelopes (interval);
+
+    // Route: each active slot is one vector op across all voices
+    for (int d = 1; d < numDestinations; ++d)
+        juce::FloatVectorOperations::clear (periodEnd[(size_t) d].data(), numVoices);
+
+    for (const auto& slot : params.slots)
+    {
+        if (! slotIsActive (slot))
+            continue;
+
+        float*      dest  = periodEnd[(size_t) slot.destination].data();
+        const float scale = slot.amount * kDestinationRange[slot.destination];
+
+        switch (slot.source)
+        {
+            case srcLfo1:
+                juce::FloatVectorOperations::add (dest, lfo1Value * scale, numVoices);
+                break;
+            case srcLfo2:
+                juce::FloatVectorOperations::addWithMultiply (dest, lfo2Value.data(), scale, numVoices);
+                break;
+            case srcModEnv:
+                juce::FloatVectorOperations::addWithMultiply (dest, envLevel.data(), scale, numVoices);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void ModMatrix::advanceEnvelopes (int numSamples) noexcept
+{
+    // Linear segments, like juce::ADSR, stepped once per control period
+    const double sr      = sampleRate;
+    const float  n       = (float) numSamples;
+    const float  sustain = params.modSustain;
+    const float  attackStep = n / (float) juce::jmax (1.0, params.modAttack * sr);
+    const float  decayStep  = n * (1.0f - sustain) / (float) juce::jmax (1.0, params.modDecay * sr);
+
+    for (int v = 0; v < numVoices; ++v)
+    {
+        auto& level = envLevel[(size_t) v];
+
+        switch (envStage[(size_t) v])
+        {
+            case envAttack:
+                level += attackStep;
+                if (level >= 1.0f) { level = 1.0f; envStage[(size_t) v] = envDecay; }
+                break;
+
+            case envDecay:
+                level -= decayStep;
+                if (level <= sustain) { level = sustain; envStage[(size_t) v] = envSustain; }
+                break;
+
+            case envSustain:
+                level = sustain;
+                break;
+
+            case envRelease:
+                level -= envReleaseRate[(size_t) v] * n;
+                if (level <= 0.0f) { level = 0.0f; envStage[(size_t) v] = envIdle; }
+                break;
+
+            default:
+                level = 0.0f;
+                break;
+        }
+    }
+}
+
+void ModMatrix::skipIdle (int numSamples) noexcept
+{
+    lfo1Phase = wrapPhase (lfo1Phase + params.lfo1Rate * (float) ((double) numSamples / sampleRate));
+    lfo1Value = lfoShape (params.lfo1Shape, lfo1Phase);
+}
+
+//==============================================================================
+void ModMatrix::noteOn (int voice) noexcept
+{
+    if (! juce::isPositiveAndBelow (voice, numVoices)) return;
+
+    lfo2Phase[(size_t) voice] = 0.0f;
+    lfo2Value[(size_t) voice] = lfoShape (params.lfo2Shape, 0.0f);
+    envLevel [(size_t) voice] = 0.0f;
+    envStage [(size_t) voice] = envAttack;
+
+    // Don't let the new note glide from the previous owner's values
+    routeVoice (voice);
+}
+
+void ModMatrix::noteOff (int voice) noexcept
+{
+    if (! juce::isPositiveAndBelow (voice, numVoices)) return;
+    if (envStage[(size_t) voice] == envIdle) return;
+
+    envStage[(size_t) voice]       = envRelease;
+    envReleaseRate[(size_t) voice] = envLevel[(size_t) voice]
+                                   / (float) juce::jmax (1.0, params.modRelease * sampleRate);
+}
+
+void ModMatrix::kill (int voice) noexcept
+{
+    if (! juce::isPositiveAndBelow (voice, numVoices)) return;
+
+    envLevel[(size_t) voice] = 0.0f;
+    envStage[(size_t) voice] = envIdle;
+}
+
+float ModMatrix::sourceValue (int source, int voice) const noexcept
+{
+    switch (source)
+    {
+        case srcLfo1:   return lfo1Value;
+        case srcLfo2:   return lfo2Value[(size_t) voice];
+        case srcModEnv: return envLevel [(size_t) voice];
+        default:        return 0.0f;
+    }
+}
+
+void ModMatrix::routeVoice (int voice) noexcept
+{
+    for (int d = 0; d < numDestinations; ++d)
+        periodEnd[(size_t) d][(size_t) voice] = 0.0f;
+
+    for (const auto& slot : params.slots)
+        if (slotIsActive (slot))
+            periodEnd[(size_t) slot.destination][(size_t) voice]
+                += slot.amount * kDestinationRange[slot.destination] * sourceValue (slot.source, voice);
+
+    for (int d = 0; d < numDestinations; ++d)
+        periodStart[(size_t) d][(size_t) voice] = periodEnd[(size_t) d][(size_t) voice];
+}
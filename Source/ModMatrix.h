@@ -0,0 +1,110 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+// Modulation parameters passed from processor to the matrix each block
+struct ModParams
+{
+    static constexpr int numSlots = 4;
+
+    struct Slot
+    {
+        int   source      = 0;     // ModMatrix::Source
+        int   destination = 0;     // ModMatrix::Destination
+        float amount      = 0.0f;  // bipolar depth (-1.0–1.0)
+    };
+
+    float lfo1Rate   = 1.0f;  // global LFO, Hz (free-running)
+    int   lfo1Shape  = 0;     // 0=Sine 1=Triangle 2=Saw 3=Square
+    float lfo2Rate   = 4.0f;  // per-voice LFO, Hz (restarts on note-on)
+    int   lfo2Shape  = 0;
+    float modAttack  = 0.01f; // modulation envelope, per voice
+    float modDecay   = 0.30f;
+    float modSustain = 0.00f;
+    float modRelease = 0.20f;
+    int   controlInterval = 32; // samples between control-rate updates
+
+    std::array<Slot, numSlots> slots {};
+};
+
+// ---- Modulation matrix ----
+// Sources are evaluated once per control period for all voices at once and
+// stored voice-contiguous (SoA), so a routing is a single vector add across
+// voices.  Each period holds the destination values at its start and end;
+// voices interpolate linearly between them at audio rate.
+class ModMatrix
+{
+public:
+    enum Source      { srcNone = 0, srcLfo1, srcLfo2, srcModEnv, numSources };
+    enum Destination { dstNone = 0, dstCutoff, dstFocus, dstDrive, dstSubBlend,
+                       dstPitch, dstVolume, numDestinations };
+
+    static constexpr int maxVoices = 32;
+
+    void prepare       (double sampleRate, int numVoices);
+    void setParameters (const ModParams& p) noexcept;
+
+    // Audio thread, from SynthEngine::renderVoices: tick() when a period ends, then render
+    // up to getSamplesUntilTick() samples starting at blockSample, then advance().
+    bool needsTick() const noexcept          { return periodPos >= interval; }
+    int  getSamplesUntilTick() const noexcept { return interval - periodPos; }
+    void tick() noexcept;
+    void beginSpan (int blockSample) noexcept { spanOrigin = blockSample; }
+    void advance   (int numSamples) noexcept  { periodPos += numSamples; }
+
+    // Idle blocks (no voice sounding, no render): keeps the free-running LFO
+    // moving without stepping any control periods
+    void skipIdle (int numSamples) noexcept;
+
+    // Voice callbacks (from startNote / stopNote)
+    void noteOn  (int voice) noexcept;
+    void noteOff (int voice) noexcept;
+    void kill    (int voice) noexcept;
+
+    // Destination values (unscaled units: semitones, Q, 0–1 …) for a voice at
+    // the start and end of the current control period
+    float startValue (int destination, int voice) const noexcept { return periodStart[(size_t) destination][(size_t) voice]; }
+    float endValue   (int destination, int voice) const noexcept { return periodEnd  [(size_t) destination][(size_t) voice]; }
+
+    // Interpolation position (0–1) within the current period of a sample index
+    // of the block being rendered, and its per-sample increment
+    float periodPosition (int blockSample) const noexcept { return (float) (periodPos + blockSample - spanOrigin) * invInterval; }
+    float periodStep() const noexcept                     { return invInterval; }
+
+    // Incremented on every tick(); voices use it to refresh derived values once per period
+    juce::uint32 getTickCount() const noexcept { return tickCount; }
+
+private:
+    using VoiceArray = std::array<float, maxVoices>;
+
+    enum EnvStage { envIdle = 0, envAttack, envDecay, envSustain, envRelease };
+
+    void advanceEnvelopes (int numSamples) noexcept;
+    void routeVoice (int voice) noexcept;
+    float sourceValue (int source, int voice) const noexcept;
+
+    ModParams params;
+    double sampleRate = 44100.0;
+    int    numVoices  = 0;
+
+    int   interval    = 32;
+    float invInterval = 1.0f / 32.0f;
+    int   periodPos   = 32;  // forces a tick before the first render
+    int   spanOrigin  = 0;
+    juce::uint32 tickCount = 0;
+
+    // Global LFO
+    float lfo1Phase = 0.0f;
+    float lfo1Value = 0.0f;
+
+    // Per-voice sources (SoA)
+    alignas (16) VoiceArray lfo2Phase {};
+    alignas (16) VoiceArray lfo2Value {};
+    alignas (16) VoiceArray envLevel {};
+    alignas (16) VoiceArray envReleaseRate {};
+    std::array<int, maxVoices> envStage {};
+
+    // Destination values at the start and end of the current period (SoA)
+    std::array<VoiceArray, numDestinations> periodStart {};
+    std::array<VoiceArray, numDestinations> periodEnd {};
+};
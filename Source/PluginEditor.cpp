@@ -8,7 +8,7 @@ static const juce::Colour kTextLight { 0xffccccdd };
 SynthPluginAudioProcessorEditor::SynthPluginAudioProcessorEditor (SynthPluginAudioProcessor& p)
     : AudioProcessorEditor (&p), audioProcessor (p)
 {
-    setSize (660, 340);
+    setSize (660, 600);
 
     // ---- Waveform combo ----
     waveformLabel.setText ("WAVEFORM", juce::dontSendNotification);
@@ -44,6 +44,80 @@ SynthPluginAudioProcessorEditor::SynthPluginAudioProcessorEditor (SynthPluginAud
     focusAtt    = std::make_unique<SliderAttach> (audioProcessor.apvts, "focus",    focusSlider);
     subBlendAtt = std::make_unique<SliderAttach> (audioProcessor.apvts, "subBlend", subBlendSlider);
     volumeAtt   = std::make_unique<SliderAttach> (audioProcessor.apvts, "volume",   volumeSlider);
+
+    // ---- Modulation: LFOs ----
+    for (auto* box : { &lfo1ShapeBox, &lfo2ShapeBox })
+    {
+        box->addItem ("Sine",     1);
+        box->addItem ("Triangle", 2);
+        box->addItem ("Saw",      3);
+        box->addItem ("Square",   4);
+        addAndMakeVisible (*box);
+    }
+
+    setupKnob (lfo1RateSlider, lfo1RateLabel, "LFO 1");
+    setupKnob (lfo2RateSlider, lfo2RateLabel, "LFO 2");
+
+    modRateLabel.setText ("MOD RATE", juce::dontSendNotification);
+    modRateLabel.setJustificationType (juce::Justification::centredLeft);
+    modRateLabel.setColour (juce::Label::textColourId, kAccent);
+    addAndMakeVisible (modRateLabel);
+
+    modRateBox.addItem ("16 samples",  1);
+    modRateBox.addItem ("32 samples",  2);
+    modRateBox.addItem ("64 samples",  3);
+    modRateBox.addItem ("128 samples", 4);
+    addAndMakeVisible (modRateBox);
+
+    // ---- Modulation: envelope ----
+    setupKnob (modAttackSlider,  modAttackLabel,  "ATTACK");
+    setupKnob (modDecaySlider,   modDecayLabel,   "DECAY");
+    setupKnob (modSustainSlider, modSustainLabel, "SUSTAIN");
+    setupKnob (modReleaseSlider, modReleaseLabel, "RELEASE");
+
+    // ---- Modulation: matrix slots ----
+    for (int i = 0; i < ModParams::numSlots; ++i)
+    {
+        auto& slot = modSlots[(size_t) i];
+        auto  n    = juce::String (i + 1);
+
+        slot.source.addItem ("None",    1);
+        slot.source.addItem ("LFO 1",   2);
+        slot.source.addItem ("LFO 2",   3);
+        slot.source.addItem ("Mod Env", 4);
+        addAndMakeVisible (slot.source);
+
+        slot.destination.addItem ("None",   1);
+        slot.destination.addItem ("Cutoff", 2);
+        slot.destination.addItem ("Focus",  3);
+        slot.destination.addItem ("Drive",  4);
+        slot.destination.addItem ("Sub",    5);
+        slot.destination.addItem ("Pitch",  6);
+        slot.destination.addItem ("Volume", 7);
+        addAndMakeVisible (slot.destination);
+
+        slot.amount.setSliderStyle (juce::Slider::LinearHorizontal);
+        slot.amount.setTextBoxStyle (juce::Slider::TextBoxRight, false, 48, 16);
+        slot.amount.setColour (juce::Slider::trackColourId,          kAccent);
+        slot.amount.setColour (juce::Slider::thumbColourId,          juce::Colours::white);
+        slot.amount.setColour (juce::Slider::textBoxTextColourId,    kTextLight);
+        slot.amount.setColour (juce::Slider::textBoxOutlineColourId, juce::Colours::transparentBlack);
+        addAndMakeVisible (slot.amount);
+
+        modSourceAtts[(size_t) i] = std::make_unique<ComboAttach>  (audioProcessor.apvts, "modSrc" + n, slot.source);
+        modDestAtts  [(size_t) i] = std::make_unique<ComboAttach>  (audioProcessor.apvts, "modDst" + n, slot.destination);
+        modAmountAtts[(size_t) i] = std::make_unique<SliderAttach> (audioProcessor.apvts, "modAmt" + n, slot.amount);
+    }
+
+    lfo1ShapeAtt  = std::make_unique<ComboAttach>  (audioProcessor.apvts, "lfo1Shape",  lfo1ShapeBox);
+    lfo2ShapeAtt  = std::make_unique<ComboAttach>  (audioProcessor.apvts, "lfo2Shape",  lfo2ShapeBox);
+    modRateAtt    = std::make_unique<ComboAttach>  (audioProcessor.apvts, "modRate",    modRateBox);
+    lfo1RateAtt   = std::make_unique<SliderAttach> (audioProcessor.apvts, "lfo1Rate",   lfo1RateSlider);
+    lfo2RateAtt   = std::make_unique<SliderAttach> (audioProcessor.apvts, "lfo2Rate",   lfo2RateSlider);
+    modAttackAtt  = std::make_unique<SliderAttach> (audioProcessor.apvts, "modAttack",  modAttackSlider);
+    modDecayAtt   = std::make_unique<SliderAttach> (audioProcessor.apvts, "modDecay",   modDecaySlider);
+    modSustainAtt = std::make_unique<SliderAttach> (audioProcessor.apvts, "modSustain", modSustainSlider);
+    modReleaseAtt = std::make_unique<SliderAttach> (audioProcessor.apvts, "modRelease", modReleaseSlider);
 }
 
 SynthPluginAudioProcessorEditor::~SynthPluginAudioProcessorEditor() {}
@@ -89,6 +163,9 @@ void SynthPluginAudioProcessorEditor::paint (juce::Graphics& g)
     g.fillRoundedRectangle (156.0f, 44.0f, 198.0f, 288.0f, 6.0f);  // Envelope
     g.fillRoundedRectangle (362.0f, 44.0f, 150.0f, 288.0f, 6.0f);  // Bass
     g.fillRoundedRectangle (520.0f, 44.0f, 132.0f, 288.0f, 6.0f);  // Output
+    g.fillRoundedRectangle (  8.0f, 340.0f, 198.0f, 252.0f, 6.0f);  // LFOs
+    g.fillRoundedRectangle (214.0f, 340.0f, 198.0f, 252.0f, 6.0f);  // Mod envelope
+    g.fillRoundedRectangle (420.0f, 340.0f, 232.0f, 252.0f, 6.0f);  // Matrix
 
     // Section header text
     g.setColour (kAccent);
@@ -97,6 +174,9 @@ void SynthPluginAudioProcessorEditor::paint (juce::Graphics& g)
     g.drawText ("ENVELOPE",   juce::Rectangle<int> (156, 44, 198, 18), juce::Justification::centred);
     g.drawText ("BASS",       juce::Rectangle<int> (362, 44, 150, 18), juce::Justification::centred);
     g.drawText ("OUTPUT",     juce::Rectangle<int> (520, 44, 132, 18), juce::Justification::centred);
+    g.drawText ("LFO",        juce::Rectangle<int> (  8, 340, 198, 18), juce::Justification::centred);
+    g.drawText ("MOD ENV",    juce::Rectangle<int> (214, 340, 198, 18), juce::Justification::centred);
+    g.drawText ("MATRIX",     juce::Rectangle<int> (420, 340, 232, 18), juce::Justification::centred);
 }
 
 void SynthPluginAudioProcessorEditor::resized()
@@ -146,4 +226,47 @@ void SynthPluginAudioProcessorEditor::resized()
 
     volumeLabel .setBounds (outX, outY,      kW, kH);
     volumeSlider.setBounds (outX, outY + kH, kW, kK);
+
+    // ---- LFO section (x=8, w=198) — two columns + mod rate ----
+    int lfoX1 = 14;
+    int lfoX2 = lfoX1 + kW + kGap + 10;
+    int lfoY  = 360;
+
+    lfo1RateLabel .setBounds (lfoX1, lfoY,      kW, kH);
+    lfo1RateSlider.setBounds (lfoX1, lfoY + kH, kW, kK);
+    lfo1ShapeBox  .setBounds (lfoX1, lfoY + kH + kK + 4, kW + 4, 24);
+    lfo2RateLabel .setBounds (lfoX2, lfoY,      kW, kH);
+    lfo2RateSlider.setBounds (lfoX2, lfoY + kH, kW, kK);
+    lfo2ShapeBox  .setBounds (lfoX2, lfoY + kH + kK + 4, kW + 4, 24);
+
+    int rateY = lfoY + kH + kK + 4 + 24 + 12;
+    modRateLabel.setBounds (lfoX1, rateY,          186, kH);
+    modRateBox  .setBounds (lfoX1, rateY + kH + 2, 186, 24);
+
+    // ---- Mod envelope section (x=214, w=198) — 2×2 grid ----
+    int menvX1 = 220;
+    int menvX2 = menvX1 + kW + kGap + 4;
+    int menvY1 = 360;
+    int menvY2 = menvY1 + kH + kK + 14;
+
+    modAttackLabel  .setBounds (menvX1, menvY1,      kW, kH);
+    modAttackSlider .setBounds (menvX1, menvY1 + kH, kW, kK);
+    modDecayLabel   .setBounds (menvX2, menvY1,      kW, kH);
+    modDecaySlider  .setBounds (menvX2, menvY1 + kH, kW, kK);
+    modSustainLabel .setBounds (menvX1, menvY2,      kW, kH);
+    modSustainSlider.setBounds (menvX1, menvY2 + kH, kW, kK);
+    modReleaseLabel .setBounds (menvX2, menvY2,      kW, kH);
+    modReleaseSlider.setBounds (menvX2, menvY2 + kH, kW, kK);
+
+    // ---- Matrix section (x=420, w=232) — one row per slot ----
+    int mtxX = 426;
+    for (int i = 0; i < ModParams::numSlots; ++i)
+    {
+        auto& slot = modSlots[(size_t) i];
+        int   rowY = 364 + i * 56;
+
+        slot.source     .setBounds (mtxX,       rowY,      104, 22);
+        slot.destination.setBounds (mtxX + 110, rowY,      110, 22);
+        slot.amount     .setBounds (mtxX,       rowY + 26, 220, 20);
+    }
 }
@@ -30,6 +30,21 @@ private:
     juce::Label focusLabel, subBlendLabel;
     juce::Label volumeLabel;
 
+    // ---- Modulation ----
+    juce::ComboBox lfo1ShapeBox, lfo2ShapeBox, modRateBox;
+    juce::Label    modRateLabel;
+    juce::Slider   lfo1RateSlider, lfo2RateSlider;
+    juce::Label    lfo1RateLabel,  lfo2RateLabel;
+    juce::Slider   modAttackSlider, modDecaySlider, modSustainSlider, modReleaseSlider;
+    juce::Label    modAttackLabel,  modDecayLabel,  modSustainLabel,  modReleaseLabel;
+
+    struct ModSlotControls
+    {
+        juce::ComboBox source, destination;
+        juce::Slider   amount;
+    };
+    std::array<ModSlotControls, ModParams::numSlots> modSlots;
+
     // ---- APVTS attachments ----
     using SliderAttach = juce::AudioProcessorValueTreeState::SliderAttachment;
     using ComboAttach  = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
@@ -40,6 +55,12 @@ private:
     std::unique_ptr<SliderAttach> focusAtt, subBlendAtt;
     std::unique_ptr<SliderAttach> volumeAtt;
 
+    std::unique_ptr<ComboAttach>  lfo1ShapeAtt, lfo2ShapeAtt, modRateAtt;
+    std::unique_ptr<SliderAttach> lfo1RateAtt, lfo2RateAtt;
+    std::unique_ptr<SliderAttach> modAttackAtt, modDecayAtt, modSustainAtt, modReleaseAtt;
+    std::array<std::unique_ptr<ComboAttach>,  ModParams::numSlots> modSourceAtts, modDestAtts;
+    std::array<std::unique_ptr<SliderAttach>, ModParams::numSlots> modAmountAtts;
+
     void setupKnob (juce::Slider& slider, juce::Label& label, const juce::String& name);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SynthPluginAudioProcessorEditor)
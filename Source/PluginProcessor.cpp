@@ -21,6 +21,14 @@ namespace {
     };
 
     constexpr int kNumPresets = (int) std::size (kPresets);
+
+    // Modulation slot parameter IDs (kept static so the audio thread never builds strings)
+    constexpr const char* kModSrcIds[ModParams::numSlots] = { "modSrc1", "modSrc2", "modSrc3", "modSrc4" };
+    constexpr const char* kModDstIds[ModParams::numSlots] = { "modDst1", "modDst2", "modDst3", "modDst4" };
+    constexpr const char* kModAmtIds[ModParams::numSlots] = { "modAmt1", "modAmt2", "modAmt3", "modAmt4" };
+
+    // Control interval in samples for each "modRate" choice
+    constexpr int kModIntervals[] = { 16, 32, 64, 128 };
 }
 
 //==============================================================================
@@ -31,8 +39,36 @@ SynthPluginAudioProcessor::SynthPluginAudioProcessor()
 {
     synth.addSound (new SynthSound());
 
-    for (int i = 0; i < NUM_VOICES; ++i)
-        synth.addVoice (new SynthVoice());
+    synth.createVoices (NUM_VOICES);
+    synth.setModMatrix (&modMatrix);
+
+    auto raw = [this] (const char* id) { return apvts.getRawParameterValue (id); };
+
+    params.waveform   = raw ("waveform");
+    params.attack     = raw ("attack");
+    params.decay      = raw ("decay");
+    params.sustain    = raw ("sustain");
+    params.release    = raw ("release");
+    params.focus      = raw ("focus");
+    params.drive      = raw ("drive");
+    params.subBlend   = raw ("subBlend");
+    params.volume     = raw ("volume");
+    params.lfo1Rate   = raw ("lfo1Rate");
+    params.lfo1Shape  = raw ("lfo1Shape");
+    params.lfo2Rate   = raw ("lfo2Rate");
+    params.lfo2Shape  = raw ("lfo2Shape");
+    params.modAttack  = raw ("modAttack");
+    params.modDecay   = raw ("modDecay");
+    params.modSustain = raw ("modSustain");
+    params.modRelease = raw ("modRelease");
+    params.modRate    = raw ("modRate");
+
+    for (int i = 0; i < ModParams::numSlots; ++i)
+    {
+        params.modSrc[(size_t) i] = raw (kModSrcIds[i]);
+        params.modDst[(size_t) i] = raw (kModDstIds[i]);
+        params.modAmt[(size_t) i] = raw (kModAmtIds[i]);
+    }
 }
 
 SynthPluginAudioProcessor::~SynthPluginAudioProcessor() {}
@@ -75,16 +111,33 @@ void SynthPluginAudioProcessor::setCurrentProgram (int index)
     setP ("drive",     p.drive);
     setP ("subBlend",  p.subBlend);
     setP ("volume",    p.volume);
+
+    // Factory presets are unmodulated
+    for (int i = 0; i < ModParams::numSlots; ++i)
+        setP (kModSrcIds[i], 0.0f);
 }
 
 //==============================================================================
 void SynthPluginAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    synth.setCurrentPlaybackSampleRate (sampleRate);
+    synth.prepare (sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    modMatrix.prepare (sampleRate, synth.getNumVoices());
+
+    masterGain.reset (sampleRate, 0.02);
+    masterGain.setCurrentAndTargetValue (params.volume->load());
+    masterGainRamp.assign ((size_t) samplesPerBlock, 0.0f);
+
+    for (auto* v : synth.getSynthVoices())
+        v->setMasterGains (masterGainRamp.data());
 
-    for (int i = 0; i < synth.getNumVoices(); ++i)
-        if (auto* v = dynamic_cast<SynthVoice*> (synth.getVoice (i)))
-            v->prepareToPlay (sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    // Tiny host buffers: render MIDI events sample-accurately instead of
+    // letting the synth merge them into 32-sample sub-blocks
+    lowLatency = samplesPerBlock <= LOW_LATENCY_MAX_BLOCK;
+    synth.setMinimumRenderingSubdivisionSize (lowLatency ? 1 : 32, lowLatency);
+
+    voicesActive          = false;
+    voiceParamsValid      = false;
+    samplesSinceParamPoll = 0;
 }
 
 void SynthPluginAudioProcessor::releaseResources() {}
@@ -100,32 +153,90 @@ bool SynthPluginAudioProcessor::isBusesLayoutSupported (const BusesLayout& layou
 void SynthPluginAudioProcessor::updateVoiceParameters()
 {
     SynthParams p;
-    p.waveform = (int) apvts.getRawParameterValue ("waveform")->load();
-    p.attack   = apvts.getRawParameterValue ("attack")->load();
-    p.decay    = apvts.getRawParameterValue ("decay")->load();
-    p.sustain  = apvts.getRawParameterValue ("sustain")->load();
-    p.release  = apvts.getRawParameterValue ("release")->load();
-    p.focus    = apvts.getRawParameterValue ("focus")->load();
-    p.drive    = apvts.getRawParameterValue ("drive")->load();
-    p.subBlend = apvts.getRawParameterValue ("subBlend")->load();
-
-    for (int i = 0; i < synth.getNumVoices(); ++i)
-        if (auto* v = dynamic_cast<SynthVoice*> (synth.getVoice (i)))
+    p.waveform = (int) params.waveform->load();
+    p.attack   = params.attack->load();
+    p.decay    = params.decay->load();
+    p.sustain  = params.sustain->load();
+    p.release  = params.release->load();
+    p.focus    = params.focus->load();
+    p.drive    = params.drive->load();
+    p.subBlend = params.subBlend->load();
+
+    // Voices only recompute envelope rates etc. when something actually moved
+    if (!voiceParamsValid || p != lastVoiceParams)
+    {
+        for (auto* v : synth.getSynthVoices())
             v->updateParams (p);
+
+        lastVoiceParams  = p;
+        voiceParamsValid = true;
+    }
+
+    ModParams m;
+    m.lfo1Rate   = params.lfo1Rate->load();
+    m.lfo1Shape  = (int) params.lfo1Shape->load();
+    m.lfo2Rate   = params.lfo2Rate->load();
+    m.lfo2Shape  = (int) params.lfo2Shape->load();
+    m.modAttack  = params.modAttack->load();
+    m.modDecay   = params.modDecay->load();
+    m.modSustain = params.modSustain->load();
+    m.modRelease = params.modRelease->load();
+
+    int rate = juce::jlimit (0, (int) std::size (kModIntervals) - 1, (int) params.modRate->load());
+    m.controlInterval = kModIntervals[rate];
+
+    for (size_t i = 0; i < (size_t) ModParams::numSlots; ++i)
+    {
+        m.slots[i].source      = (int) params.modSrc[i]->load();
+        m.slots[i].destination = (int) params.modDst[i]->load();
+        m.slots[i].amount      = params.modAmt[i]->load();
+    }
+
+    modMatrix.setParameters (m);
 }
 
 void SynthPluginAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
                                                juce::MidiBuffer& midi)
 {
     juce::ScopedNoDenormals noDenormals;
-    buffer.clear();
 
-    updateVoiceParameters();
-    synth.renderNextBlock (buffer, midi, 0, buffer.getNumSamples());
+    const int numSamples = buffer.getNumSamples();
+    masterGain.setTargetValue (params.volume->load());
 
-    // Master volume
-    float vol = apvts.getRawParameterValue ("volume")->load();
-    buffer.applyGain (vol);
+    // Idle: nothing sounding and nothing to start — output silence and leave.
+    // clear() also flags the buffer as silent (hasBeenCleared) for the wrapper.
+    if (!voicesActive && midi.isEmpty())
+    {
+        masterGain.skip (numSamples);
+        modMatrix.skipIdle (numSamples);
+        buffer.clear();
+        return;
+    }
+
+    buffer.clear();
+
+    // Low-latency hosts call us every few samples; polling ~30 parameters on
+    // each call would dominate, so poll at a fixed sample interval instead
+    // (always on the first block after idle so new notes see current values)
+    samplesSinceParamPoll += numSamples;
+    if (!lowLatency || !voicesActive || samplesSinceParamPoll >= PARAM_POLL_INTERVAL)
+    {
+        updateVoiceParameters();
+        samplesSinceParamPoll = 0;
+    }
+
+    // Master volume ramp for this block; voices multiply it in while accumulating
+    jassert (numSamples <= (int) masterGainRamp.size());
+    if (masterGain.isSmoothing())
+        for (int s = 0; s < numSamples; ++s)
+            masterGainRamp[(size_t) s] = masterGain.getNextValue();
+    else
+        juce::FloatVectorOperations::fill (masterGainRamp.data(), masterGain.getTargetValue(), numSamples);
+
+    // One render call per block; SynthEngine splits at modulation control ticks
+    synth.renderNextBlock (buffer, midi, 0, numSamples);
+
+    voicesActive = synth.anyVoiceActive();
 }
 
 //==============================================================================
@@ -193,6 +304,59 @@ SynthPluginAudioProcessor::createParameterLayout()
         "volume", "Volume",
         juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.70f));
 
+    // ---- Modulation ----
+    // LFO shapes: 0=Sine 1=Triangle 2=Saw 3=Square
+    layout.add (std::make_unique<juce::AudioParameterFloat> (
+        "lfo1Rate", "LFO 1 Rate",
+        juce::NormalisableRange<float> (0.01f, 20.0f, 0.001f, 0.4f), 1.0f));
+
+    layout.add (std::make_unique<juce::AudioParameterInt> (
+        "lfo1Shape", "LFO 1 Shape", 0, 3, 0));
+
+    layout.add (std::make_unique<juce::AudioParameterFloat> (
+        "lfo2Rate", "LFO 2 Rate",
+        juce::NormalisableRange<float> (0.01f, 20.0f, 0.001f, 0.4f), 4.0f));
+
+    layout.add (std::make_unique<juce::AudioParameterInt> (
+        "lfo2Shape", "LFO 2 Shape", 0, 3, 0));
+
+    layout.add (std::make_unique<juce::AudioParameterFloat> (
+        "modAttack", "Mod Attack",
+        juce::NormalisableRange<float> (0.001f, 5.0f, 0.001f, 0.5f), 0.01f));
+
+    layout.add (std::make_unique<juce::AudioParameterFloat> (
+        "modDecay", "Mod Decay",
+        juce::NormalisableRange<float> (0.001f, 3.0f, 0.001f, 0.5f), 0.30f));
+
+    layout.add (std::make_unique<juce::AudioParameterFloat> (
+        "modSustain", "Mod Sustain",
+        juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.0f));
+
+    layout.add (std::make_unique<juce::AudioParameterFloat> (
+        "modRelease", "Mod Release",
+        juce::NormalisableRange<float> (0.001f, 8.0f, 0.001f, 0.5f), 0.20f));
+
+    // Control interval: 0=16 1=32 2=64 3=128 samples
+    layout.add (std::make_unique<juce::AudioParameterInt> (
+        "modRate", "Mod Rate", 0, 3, 1));
+
+    // Slots — source: 0=None 1=LFO 1 2=LFO 2 3=Mod Env
+    //         dest:   0=None 1=Cutoff 2=Focus 3=Drive 4=Sub 5=Pitch 6=Volume
+    for (int i = 0; i < ModParams::numSlots; ++i)
+    {
+        auto n = juce::String (i + 1);
+
+        layout.add (std::make_unique<juce::AudioParameterInt> (
+            kModSrcIds[i], "Mod " + n + " Source", 0, ModMatrix::numSources - 1, 0));
+
+        layout.add (std::make_unique<juce::AudioParameterInt> (
+            kModDstIds[i], "Mod " + n + " Dest", 0, ModMatrix::numDestinations - 1, 0));
+
+        layout.add (std::make_unique<juce::AudioParameterFloat> (
+            kModAmtIds[i], "Mod " + n + " Amount",
+            juce::NormalisableRange<float> (-1.0f, 1.0f, 0.001f), 0.0f));
+    }
+
     return layout;
 }
 
@@ -1,6 +1,6 @@
 #pragma once
 #include <JuceHeader.h>
-#include "SynthVoice.h"
+#include "SynthEngine.h"
 
 class SynthPluginAudioProcessor : public juce::AudioProcessor
 {
@@ -35,12 +35,61 @@ public:
 
     juce::AudioProcessorValueTreeState apvts;
 
+    // Set by prepareToPlay for hosts running at LOW_LATENCY_MAX_BLOCK samples or less
+    bool isLowLatencyMode() const noexcept { return lowLatency; }
+
+    // Memory the voices render from: the voice arena and the shared scratch buffer
+    size_t getVoiceArenaBytes() const noexcept { return synth.getVoiceArenaBytes(); }
+    size_t getScratchBytes()    const noexcept { return synth.getScratchBytes(); }
+
 private:
-    static constexpr int NUM_VOICES = 16;
+    static constexpr int NUM_VOICES            = 16;
+    static constexpr int LOW_LATENCY_MAX_BLOCK = 64;
+    static constexpr int PARAM_POLL_INTERVAL   = 32; // samples, low-latency mode
 
-    juce::Synthesiser synth;
+    // Raw parameter values, looked up once so the audio thread never searches by ID
+    struct ParameterRefs
+    {
+        std::atomic<float>* waveform   = nullptr;
+        std::atomic<float>* attack     = nullptr;
+        std::atomic<float>* decay      = nullptr;
+        std::atomic<float>* sustain    = nullptr;
+        std::atomic<float>* release    = nullptr;
+        std::atomic<float>* focus      = nullptr;
+        std::atomic<float>* drive      = nullptr;
+        std::atomic<float>* subBlend   = nullptr;
+        std::atomic<float>* volume     = nullptr;
+        std::atomic<float>* lfo1Rate   = nullptr;
+        std::atomic<float>* lfo1Shape  = nullptr;
+        std::atomic<float>* lfo2Rate   = nullptr;
+        std::atomic<float>* lfo2Shape  = nullptr;
+        std::atomic<float>* modAttack  = nullptr;
+        std::atomic<float>* modDecay   = nullptr;
+        std::atomic<float>* modSustain = nullptr;
+        std::atomic<float>* modRelease = nullptr;
+        std::atomic<float>* modRate    = nullptr;
+        std::array<std::atomic<float>*, ModParams::numSlots> modSrc {}, modDst {}, modAmt {};
+    };
+
+    SynthEngine synth;
+    ModMatrix   modMatrix;
     int currentProgram = 0;
 
+    // Master volume, smoothed and applied by the voices as they accumulate
+    juce::SmoothedValue<float> masterGain;
+    std::vector<float>         masterGainRamp;
+
+    // False once every voice has finished; lets idle blocks skip all DSP
+    bool voicesActive = false;
+
+    ParameterRefs params;
+    SynthParams   lastVoiceParams;
+    bool          voiceParamsValid = false;
+
+    // Low-latency mode: exact MIDI timing, parameters polled every PARAM_POLL_INTERVAL samples
+    bool lowLatency            = false;
+    int  samplesSinceParamPoll = 0;
+
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     void updateVoiceParameters();
 
@@ -0,0 +1,130 @@
+#pragma once
+#include <JuceHeader.h>
+#include <new>
+#include <vector>
+#include "SynthVoice.h"
+
+// juce::Synthesiser that keeps its voices as SynthVoice* as well. Per-block
+// voice work goes through the typed list: no dynamic_cast, and since
+// SynthVoice is final the render/active calls are resolved statically.
+// Idle voices are skipped before any render call is made.
+//
+// Voices are constructed side by side in a single cache-line-aligned arena
+// and share one mono render scratch buffer.
+//
+// The modulation matrix is clocked from renderVoices: the base class calls it
+// once per MIDI-free range, and each range is split further so no render call
+// crosses a control tick. MIDI is consumed exactly once, by the base class.
+class SynthEngine : public juce::Synthesiser
+{
+public:
+    ~SynthEngine() override { destroyVoices(); }
+
+    // Builds numVoices voices in the arena and registers them with the base
+    // class, which holds them but must never delete them (see destroyVoices)
+    void createVoices (int numVoices)
+    {
+        jassert (arena == nullptr && numVoices > 0);
+
+        arena = static_cast<SynthVoice*> (::operator new (sizeof (SynthVoice) * (size_t) numVoices,
+                                                          std::align_val_t { alignof (SynthVoice) }));
+
+        for (int i = 0; i < numVoices; ++i)
+        {
+            auto* v = new (arena + i) SynthVoice();
+            synthVoices.push_back (v);
+            addVoice (v);
+        }
+    }
+
+    void prepare (double sampleRate, int samplesPerBlock, int numChannels)
+    {
+        setCurrentPlaybackSampleRate (sampleRate);
+        scratch.assign ((size_t) samplesPerBlock, 0.0f);
+
+        for (auto* v : synthVoices)
+        {
+            v->prepareToPlay (sampleRate, samplesPerBlock, numChannels);
+            v->setScratch (scratch.data(), samplesPerBlock);
+        }
+    }
+
+    // Connects every voice to its column of the matrix and lets renderVoices clock it
+    void setModMatrix (ModMatrix* matrix) noexcept
+    {
+        modMatrix = matrix;
+
+        for (size_t i = 0; i < synthVoices.size(); ++i)
+            synthVoices[i]->setModMatrix (matrix, (int) i);
+    }
+
+    const std::vector<SynthVoice*>& getSynthVoices() const noexcept { return synthVoices; }
+
+    bool anyVoiceActive() const noexcept
+    {
+        for (auto* v : synthVoices)
+            if (v->isVoiceActive())
+                return true;
+        return false;
+    }
+
+    size_t getVoiceArenaBytes() const noexcept { return sizeof (SynthVoice) * synthVoices.size(); }
+    size_t getScratchBytes()    const noexcept { return scratch.size() * sizeof (float); }
+
+protected:
+    using juce::Synthesiser::renderVoices;
+
+    void renderVoices (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) override
+    {
+        if (modMatrix == nullptr)
+        {
+            renderSpan (outputAudio, startSample, numSamples);
+            return;
+        }
+
+        while (numSamples > 0)
+        {
+            if (modMatrix->needsTick())
+                modMatrix->tick();
+
+            const int len = juce::jmin (numSamples, modMatrix->getSamplesUntilTick());
+            modMatrix->beginSpan (startSample);
+            renderSpan (outputAudio, startSample, len);
+            modMatrix->advance (len);
+
+            startSample += len;
+            numSamples  -= len;
+        }
+    }
+
+private:
+    void renderSpan (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+    {
+        for (auto* v : synthVoices)
+            if (v->isVoiceActive())
+                v->renderNextBlock (outputAudio, startSample, numSamples);
+    }
+
+    void destroyVoices()
+    {
+        {
+            const juce::ScopedLock sl (lock);
+            voices.clear (false); // arena-owned: don't let OwnedArray delete them
+        }
+
+        for (auto* v : synthVoices)
+            v->~SynthVoice();
+
+        synthVoices.clear();
+
+        if (arena != nullptr)
+            ::operator delete (arena, std::align_val_t { alignof (SynthVoice) });
+
+        arena = nullptr;
+    }
+
+    SynthVoice*              arena     = nullptr;
+    ModMatrix*               modMatrix = nullptr;
+    std::vector<SynthVoice*> synthVoices;
+    std::vector<float>       scratch;
+};
@@ -1,5 +1,43 @@
 #include "SynthVoice.h"
 
+namespace {
+    constexpr float kPhaseToUnit    = 1.0f / 4294967296.0f;
+    constexpr float kPhaseToRadians = juce::MathConstants<float>::twoPi / 4294967296.0f;
+    constexpr float kMaxPhaseInc    = 2147483647.0f;  // Nyquist
+
+    // Waveform at a 32-bit phase (full cycle = 2^32)
+    inline float oscillator (juce::uint32 phase, int waveform) noexcept
+    {
+        switch (waveform)
+        {
+            case 0: // Pure — clean sine
+                return std::sin ((float) phase * kPhaseToRadians);
+
+            case 1: // Soft — triangle (gentle odd harmonics)
+            {
+                float t = (float) phase * kPhaseToUnit;
+                return t < 0.5f ? 4.0f * t - 1.0f : 3.0f - 4.0f * t;
+            }
+
+            case 2: // Warm — 0.85·sin(φ) + 0.15·sin(3φ); 3φ wraps for free in 32 bits
+                return 0.85f * std::sin ((float) phase * kPhaseToRadians)
+                     + 0.15f * std::sin ((float) (phase * 3u) * kPhaseToRadians);
+
+            case 3: // Punch — square
+                return phase < 0x80000000u ? 1.0f : -1.0f;
+
+            case 4: // Grit — hard-clipped sawtooth
+            {
+                float saw = 1.0f - 2.0f * ((float) phase * kPhaseToUnit);
+                return juce::jlimit (-0.7f, 0.7f, saw) / 0.7f;
+            }
+
+            default:
+                return std::sin ((float) phase * kPhaseToRadians);
+        }
+    }
+}
+
 SynthVoice::SynthVoice() {}
 
 bool SynthVoice::canPlaySound (juce::SynthesiserSound* sound)
@@ -10,52 +48,58 @@ bool SynthVoice::canPlaySound (juce::SynthesiserSound* sound)
 void SynthVoice::startNote (int midiNoteNumber, float velocity,
                              juce::SynthesiserSound*, int)
 {
-    currentPhase = 0.0;
-    subPhase     = 0.0;
-    level        = velocity * 0.8f;
+    hot.phase    = 0;
+    hot.subPhase = 0;
+    hot.level    = velocity * 0.8f;
 
     baseFrequency = juce::MidiMessage::getMidiNoteInHertz (midiNoteNumber);
 
     double sr     = getSampleRate();
-    phaseDelta    = baseFrequency / sr * juce::MathConstants<double>::twoPi;
-    subDelta      = phaseDelta * 0.5;
+    hot.phaseInc  = (juce::uint32) juce::jmin ((double) kMaxPhaseInc, baseFrequency / sr * 4294967296.0);
 
-    // Key-track: set bandpass center to the note's frequency immediately
-    // so first block uses the correct frequency even before updateParams runs
-    double safeFreq = juce::jlimit (20.0, sr * 0.5 - 10.0, baseFrequency);
-    filter.setCutoffFrequency ((float) safeFreq);
+    if (modMatrix != nullptr)
+        modMatrix->noteOn (voiceIndex);
+    // Key-track: the first render derives the bandpass centre from the new note
+    modDirty = true;
 
-    adsr.noteOn();
-    filter.reset();
+    // Envelope note-on (matches juce::ADSR: attack from the current level)
+    hot.envStage = envAttack;
+    hot.s1 = hot.s2 = 0.0f;
 }
 
 void SynthVoice::stopNote (float /*velocity*/, bool allowTailOff)
 {
     if (allowTailOff)
-        adsr.noteOff();
+    {
+        if (hot.envStage != envIdle)
+        {
+            hot.releaseRate = hot.envLevel / (float) juce::jmax (1.0, release * getSampleRate());
+            hot.envStage    = envRelease;
+        }
+
+        if (modMatrix != nullptr)
+            modMatrix->noteOff (voiceIndex);
+    }
     else
     {
-        adsr.reset();
+        hot.envLevel = 0.0f;
+        hot.envStage = envIdle;
+        if (modMatrix != nullptr)
+            modMatrix->kill (voiceIndex);
         clearCurrentNote();
     }
 }
 
-void SynthVoice::prepareToPlay (double sampleRate, int samplesPerBlock, int numChannels)
+void SynthVoice::prepareToPlay (double /*sampleRate*/, int /*samplesPerBlock*/, int /*numChannels*/)
 {
-    adsr.setSampleRate (sampleRate);
+    // The voice is mono: it's filtered once and added to every output channel.
+    // Scratch memory is owned by SynthEngine and shared between voices.
+    hot.envLevel = 0.0f;
+    hot.envStage = envIdle;
+    hot.s1 = hot.s2 = 0.0f;
 
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate       = sampleRate;
-    spec.maximumBlockSize = (juce::uint32) samplesPerBlock;
-    spec.numChannels      = (juce::uint32) numChannels;
-
-    filter.prepare (spec);
-    filter.setType (juce::dsp::StateVariableTPTFilterType::bandpass);
-    filter.setCutoffFrequency (80.0f);
-    filter.setResonance (3.0f);
-
-    subSamples.resize ((size_t) samplesPerBlock, 0.0f);
-    adsrSamples.resize ((size_t) samplesPerBlock, 0.0f);
+    updateEnvelopeRates();
+    modDirty = true;
 
     isPrepared = true;
 }
@@ -64,129 +108,187 @@ void SynthVoice::updateParams (const SynthParams& p)
 {
     if (getSampleRate() <= 0.0) return;
 
-    waveform  = p.waveform;
-    focus     = p.focus;
-    drive     = p.drive;
-    subBlend  = p.subBlend;
-
-    adsrParams.attack  = p.attack;
-    adsrParams.decay   = p.decay;
-    adsrParams.sustain = p.sustain;
-    adsrParams.release = p.release;
-    adsr.setParameters (adsrParams);
-
-    double sr       = getSampleRate();
-    double safeFreq = juce::jlimit (20.0, sr * 0.5 - 10.0, baseFrequency);
-    filter.setCutoffFrequency ((float) safeFreq);
-    filter.setResonance (juce::jlimit (0.1f, 10.0f, focus));
+    hot.waveform = (juce::uint8) juce::jlimit (0, 4, p.waveform);
+    focus        = p.focus;
+    drive        = p.drive;
+    subBlend     = p.subBlend;
+
+    attack       = p.attack;
+    decay        = p.decay;
+    hot.sustain  = p.sustain;
+    release      = p.release;
+    updateEnvelopeRates();
+
+    // Filter coefficient endpoints are modulated, so they're derived per control period
+    modDirty = true;
 }
 
-float SynthVoice::generateSample() noexcept
+void SynthVoice::updateEnvelopeRates() noexcept
 {
-    float sample = 0.0f;
+    double sr = getSampleRate();
+    if (sr <= 0.0) return;
+
+    hot.attackRate = (float) (1.0 / juce::jmax (1.0, attack * sr));
+    hot.decayRate  = (float) ((1.0 - hot.sustain) / juce::jmax (1.0, decay * sr));
+}
 
-    switch (waveform)
+float SynthVoice::nextEnvelope (HotState& st) noexcept
+{
+    switch (st.envStage)
     {
-        case 0: // Pure — clean sine
-            sample = (float) std::sin (currentPhase);
+        case envAttack:
+            st.envLevel += st.attackRate;
+            if (st.envLevel >= 1.0f) { st.envLevel = 1.0f; st.envStage = envDecay; }
             break;
 
-        case 1: // Soft — triangle (gentle odd harmonics)
-        {
-            double t = currentPhase / juce::MathConstants<double>::twoPi;
-            sample = (float) (t < 0.5 ? 4.0 * t - 1.0 : 3.0 - 4.0 * t);
+        case envDecay:
+            st.envLevel -= st.decayRate;
+            if (st.envLevel <= st.sustain) { st.envLevel = st.sustain; st.envStage = envSustain; }
             break;
-        }
 
-        case 2: // Warm — 0.85·sin(φ) + 0.15·sin(3φ)
-            sample = 0.85f * (float) std::sin (currentPhase)
-                   + 0.15f * (float) std::sin (3.0 * currentPhase);
+        case envSustain:
+            st.envLevel = st.sustain;
             break;
 
-        case 3: // Punch — square
-            sample = currentPhase < juce::MathConstants<double>::pi ? 1.0f : -1.0f;
+        case envRelease:
+            st.envLevel -= st.releaseRate;
+            if (st.envLevel <= 0.0f) { st.envLevel = 0.0f; st.envStage = envIdle; }
             break;
 
-        case 4: // Grit — hard-clipped sawtooth
-        {
-            float saw = (float) (1.0 - currentPhase / juce::MathConstants<double>::pi);
-            sample = juce::jlimit (-0.7f, 0.7f, saw) / 0.7f;
-            break;
-        }
-
         default:
-            sample = (float) std::sin (currentPhase);
+            return 0.0f;
     }
 
-    currentPhase += phaseDelta;
-    if (currentPhase >= juce::MathConstants<double>::twoPi)
-        currentPhase -= juce::MathConstants<double>::twoPi;
+    return st.envLevel;
+}
+
+float SynthVoice::modValue (int destination, bool atEnd) const noexcept
+{
+    if (modMatrix == nullptr) return 0.0f;
+    return atEnd ? modMatrix->endValue   (destination, voiceIndex)
+                 : modMatrix->startValue (destination, voiceIndex);
+}
+
+SynthVoice::ModFrame SynthVoice::deriveModFrame (bool atEnd) const noexcept
+{
+    ModFrame f;
+    f.ratio  = std::exp2 (modValue (ModMatrix::dstPitch, atEnd) / 12.0f);
+    f.drive  = juce::jlimit (0.0f, 1.0f, drive + modValue (ModMatrix::dstDrive, atEnd));
+    f.norm   = 1.0f / std::tanh (1.0f + f.drive * 4.0f);
+    f.sub    = juce::jlimit (0.0f, 1.0f, subBlend + modValue (ModMatrix::dstSubBlend, atEnd));
+    f.vol    = juce::jlimit (0.0f, 2.0f, 1.0f + modValue (ModMatrix::dstVolume, atEnd));
+
+    // Key-tracked bandpass centre, following pitch mod; one tan() per endpoint
+    const double sr         = getSampleRate();
+    const float  cutoffSemi = modValue (ModMatrix::dstPitch, atEnd) + modValue (ModMatrix::dstCutoff, atEnd);
+    const double cutoffHz   = juce::jlimit (20.0, sr * 0.5 - 10.0,
+                                            baseFrequency * std::exp2 ((double) cutoffSemi / 12.0));
+    const float  q          = juce::jlimit (0.5f, 10.0f, focus + modValue (ModMatrix::dstFocus, atEnd));
+
+    f.g      = (float) std::tan (juce::MathConstants<double>::pi * cutoffHz / sr);
+    f.R2     = 1.0f / q;
+
+    // JUCE bandpass peaks at Q × input; compensate so level stays consistent
+    f.comp   = 1.0f / juce::jmax (1.0f, q);
+    return f;
+}
 
-    return sample;
+void SynthVoice::refreshModulation()
+{
+    modFrom  = deriveModFrame (false);
+    modTo    = deriveModFrame (true);
+    modTick  = modMatrix != nullptr ? modMatrix->getTickCount() : 0;
+    modDirty = false;
 }
 
-float SynthVoice::applyDrive (float x) const noexcept
+float SynthVoice::applyDrive (float x, float driveAmount, float invNorm) noexcept
 {
-    if (drive <= 0.0f) return x;
-    float k = 1.0f + drive * 4.0f;
-    return std::tanh (x * k) / std::tanh (k);
+    // invNorm = 1 / tanh(k) is interpolated from the period endpoints, so only
+    // one tanh runs per sample. The lowest tenth of the range fades in from
+    // the clean signal, so modulated drive crossing 0 doesn't click.
+    if (driveAmount <= 0.0f) return x;
+    float k   = 1.0f + driveAmount * 4.0f;
+    float wet = std::tanh (x * k) * invNorm;
+    return x + (wet - x) * juce::jmin (1.0f, driveAmount * 10.0f);
 }
 
 void SynthVoice::renderNextBlock (juce::AudioBuffer<float>& outputBuffer,
                                    int startSample, int numSamples)
 {
-    if (!isPrepared || !isVoiceActive())
+    if (!isPrepared || !isVoiceActive() || scratch == nullptr)
         return;
 
-    juce::AudioBuffer<float> temp (outputBuffer.getNumChannels(), numSamples);
-    temp.clear();
-
-    bool stillActive = true;
+    jassert (numSamples <= scratchSize);
 
-    // Zero out envelope and sub arrays so samples past the break point are silent
-    std::fill (adsrSamples.begin(), adsrSamples.begin() + numSamples, 0.0f);
-    std::fill (subSamples.begin(),  subSamples.begin()  + numSamples, 0.0f);
+    // ---- Modulation: endpoints are derived once per control period ----
+    if (modDirty || (modMatrix != nullptr && modTick != modMatrix->getTickCount()))
+        refreshModulation();
 
-    for (int s = 0; s < numSamples; ++s)
-    {
-        float adsrVal = adsr.getNextSample();
-        adsrSamples[(size_t) s] = adsrVal;
+    const ModFrame& a = modFrom;
+    const ModFrame& b = modTo;
 
-        // Main oscillator: waveform → drive → temp buffer (ADSR applied post-filter)
-        float raw = applyDrive (generateSample()) * level;
-        for (int ch = 0; ch < temp.getNumChannels(); ++ch)
-            temp.setSample (ch, s, raw);
+    const float t0 = modMatrix != nullptr ? modMatrix->periodPosition (startSample) : 0.0f;
+    const float dt = modMatrix != nullptr ? modMatrix->periodStep() : 0.0f;
 
-        // Sub oscillator: pure sine one octave below, stored separately
-        subSamples[(size_t) s] = (float) std::sin (subPhase) * level * adsrVal;
-        subPhase += subDelta;
-        if (subPhase >= juce::MathConstants<double>::twoPi)
-            subPhase -= juce::MathConstants<double>::twoPi;
+    // Work on a local copy of the hot block so it stays in registers
+    HotState    st          = hot;
+    const float incF        = (float) st.phaseInc;
+    int         rendered    = numSamples;
+    bool        stillActive = true;
 
-        if (!adsr.isActive())
+    for (int s = 0; s < numSamples; ++s)
+    {
+        const float t     = t0 + (float) s * dt;
+        const float ratio = a.ratio + (b.ratio - a.ratio) * t;
+        const float vol   = a.vol   + (b.vol   - a.vol)   * t;
+        const auto  inc   = (juce::uint32) juce::jmin (incF * ratio, kMaxPhaseInc);
+
+        float env = nextEnvelope (st);
+
+        // Main oscillator: waveform → drive → bandpass (ADSR applied post-filter)
+        float raw = applyDrive (oscillator (st.phase, st.waveform),
+                                a.drive + (b.drive - a.drive) * t,
+                                a.norm  + (b.norm  - a.norm)  * t) * st.level;
+        st.phase += inc;
+
+        // Key-tracked TPT bandpass (same topology as juce::dsp::StateVariableTPTFilter),
+        // coefficients interpolated per sample so cutoff/focus modulation doesn't step
+        const float g  = a.g  + (b.g  - a.g)  * t;
+        const float R2 = a.R2 + (b.R2 - a.R2) * t;
+        const float h  = 1.0f / (1.0f + R2 * g + g * g);
+
+        float yHP = h * (raw - st.s1 * (g + R2) - st.s2);
+        float yBP = yHP * g + st.s1;
+        st.s1     = yHP * g + yBP;
+        float yLP = yBP * g + st.s2;
+        st.s2     = yBP * g + yLP;
+
+        // Sub oscillator: pure sine one octave below, unfiltered
+        float sub = std::sin ((float) st.subPhase * kPhaseToRadians) * st.level * env
+                  * (a.sub + (b.sub - a.sub) * t);
+        st.subPhase += inc >> 1;
+
+        scratch[s] = (yBP * env * (a.comp + (b.comp - a.comp) * t) + sub) * vol;
+
+        if (st.envStage == envIdle)
         {
             stillActive = false;
+            rendered    = s + 1;
             break;
         }
     }
 
-    // Apply key-tracked bandpass filter to main oscillator
-    juce::dsp::AudioBlock<float>              block (temp);
-    juce::dsp::ProcessContextReplacing<float> ctx (block);
-    filter.process (ctx);
+    hot = st;
 
-    // JUCE bandpass peaks at Q × input; compensate so level stays consistent
-    float gainComp = 1.0f / juce::jmax (1.0f, focus);
-
-    // Mix filtered main (ADSR applied here, post-filter) + unfiltered sub into output
+    // Accumulate into every output channel, folding in the master gain ramp
     for (int ch = 0; ch < outputBuffer.getNumChannels(); ++ch)
     {
-        for (int s = 0; s < numSamples; ++s)
-        {
-            float out = temp.getSample (ch, s) * gainComp * adsrSamples[(size_t) s]
-                      + subBlend * subSamples[(size_t) s];
-            outputBuffer.addSample (ch, startSample + s, out);
-        }
+        float* dest = outputBuffer.getWritePointer (ch, startSample);
+
+        if (masterGains != nullptr)
+            juce::FloatVectorOperations::addWithMultiply (dest, scratch, masterGains + startSample, rendered);
+        else
+            juce::FloatVectorOperations::add (dest, scratch, rendered);
     }
 
     if (!stillActive)
@@ -1,6 +1,6 @@
 #pragma once
 #include <JuceHeader.h>
-#include <vector>
+#include "ModMatrix.h"
 
 // Parameters passed from processor to each voice each block
 struct SynthParams
@@ -13,6 +13,17 @@ struct SynthParams
     float focus    = 3.0f;  // bandpass Q (1.0–8.0)
     float drive    = 0.0f;  // tanh saturation (0.0–1.0)
     float subBlend = 0.0f;  // sub-octave blend post-filter (0.0–1.0)
+
+    bool operator== (const SynthParams& o) const noexcept
+    {
+        using juce::exactlyEqual;
+        return waveform == o.waveform
+            && exactlyEqual (attack,   o.attack)   && exactlyEqual (decay,   o.decay)
+            && exactlyEqual (sustain,  o.sustain)  && exactlyEqual (release, o.release)
+            && exactlyEqual (focus,    o.focus)    && exactlyEqual (drive,   o.drive)
+            && exactlyEqual (subBlend, o.subBlend);
+    }
+    bool operator!= (const SynthParams& o) const noexcept { return !(*this == o); }
 };
 
 // ---- Sound (trivial – every note plays every sound) ----
@@ -24,7 +35,10 @@ public:
 };
 
 // ---- Voice ----
-class SynthVoice : public juce::SynthesiserVoice
+// Voices are placement-constructed side by side in SynthEngine's arena. The
+// state every rendered sample touches lives in one cache-line-aligned block
+// at a fixed offset; everything else is read at most once per render call.
+class SynthVoice final : public juce::SynthesiserVoice
 {
 public:
     SynthVoice();
@@ -45,28 +59,89 @@ public:
     void prepareToPlay (double sampleRate, int samplesPerBlock, int numChannels);
     void updateParams  (const SynthParams& p);
 
+    // Connects this voice to its column of the modulation matrix
+    void setModMatrix (ModMatrix* matrix, int index) noexcept { modMatrix = matrix; voiceIndex = index; }
+
+    // Per-sample master gain for the current block, multiplied in as the voice
+    // accumulates into the output (nullptr = unity)
+    void setMasterGains (const float* gains) noexcept { masterGains = gains; }
+
+    // Mono render scratch shared by all voices (they render one after another)
+    void setScratch (float* buffer, int size) noexcept { scratch = buffer; scratchSize = size; }
+
+    // Per-sample state: oscillators (32-bit phase, wraps on overflow),
+    // envelope and bandpass filter — exactly one cache line
+    struct alignas (64) HotState
+    {
+        juce::uint32 phase    = 0;
+        juce::uint32 phaseInc = 0;  // sub oscillator runs at half of this
+        juce::uint32 subPhase = 0;
+        float        level    = 0.0f;
+
+        // Envelope (linear segments, same shape as juce::ADSR)
+        float envLevel    = 0.0f;
+        float attackRate  = 0.0f;
+        float decayRate   = 0.0f;
+        float releaseRate = 0.0f;
+        float sustain     = 0.7f;
+        juce::uint8 envStage = 0;
+        juce::uint8 waveform = 0;
+
+        // TPT state-variable bandpass integrator state (coefficients are
+        // interpolated per sample from the ModFrame endpoints)
+        float s1 = 0.0f;
+        float s2 = 0.0f;
+    };
+
+    static_assert (sizeof (HotState) == 64, "HotState should fill exactly one cache line");
+
 private:
-    float generateSample() noexcept;
-    float applyDrive (float x) const noexcept;
-
-    double currentPhase  = 0.0;
-    double phaseDelta    = 0.0;
-    double subPhase      = 0.0;
-    double subDelta      = 0.0;
-    float  level         = 0.0f;
-    int    waveform      = 0;
+    enum EnvStage : juce::uint8 { envIdle = 0, envAttack, envDecay, envSustain, envRelease };
+
+    // Modulated values derived at one end of a control period
+    struct ModFrame
+    {
+        float ratio = 1.0f;  // pitch multiplier
+        float drive = 0.0f;
+        float norm  = 1.0f;  // 1 / tanh(k)
+        float g     = 0.0f;  // bandpass tan(pi·fc/sr), key-tracked incl. pitch mod
+        float R2    = 1.0f;  // bandpass 1 / Q
+        float comp  = 1.0f;  // bandpass gain compensation
+        float sub   = 0.0f;
+        float vol   = 1.0f;
+    };
+
+    static float applyDrive (float x, float driveAmount, float invNorm) noexcept;
+    static float nextEnvelope (HotState& st) noexcept;
+    float    modValue (int destination, bool atEnd) const noexcept;
+    ModFrame deriveModFrame (bool atEnd) const noexcept;
+    void     refreshModulation();
+    void     updateEnvelopeRates() noexcept;
+
+    HotState hot;
+
+    // ---- Per-call / per-period state ----
+    ModMatrix*   modMatrix   = nullptr;
+    int          voiceIndex  = 0;
+    const float* masterGains = nullptr;
+    float*       scratch     = nullptr;
+    int          scratchSize = 0;
+
+    // Recomputed once per control period (or when params / the note change)
+    ModFrame     modFrom, modTo;
+    juce::uint32 modTick  = 0;
+    bool         modDirty = true;
+
+    // ---- Cold: parameters, only read when they or the note change ----
     double baseFrequency = 440.0;
 
     float focus    = 3.0f;
     float drive    = 0.0f;
     float subBlend = 0.0f;
 
-    std::vector<float> subSamples;
-    std::vector<float> adsrSamples;
-
-    juce::ADSR                               adsr;
-    juce::ADSR::Parameters                   adsrParams;
-    juce::dsp::StateVariableTPTFilter<float> filter;
+    float attack  = 0.01f;
+    float decay   = 0.30f;
+    float release = 0.20f;
 
     bool isPrepared = false;
 
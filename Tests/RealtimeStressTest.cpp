@@ -0,0 +1,434 @@
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#if defined (__GLIBC__)
+ #include <dlfcn.h>
+#endif
+
+#if ! JUCE_WINDOWS
+ #include <pthread.h>
+ #include <sched.h>
+#endif
+
+//==============================================================================
+// Real-time safety stress test for SynthPluginAudioProcessor::processBlock.
+//
+// An audio thread renders blocks of random size under randomised MIDI storms
+// while a host thread automates parameters and a control thread switches
+// presets and saves/restores state. Heap allocations, frees and mutex
+// acquisitions made *on the audio thread inside processBlock* are counted,
+// along with per-block wall time against the block's real-time deadline.
+//
+// The audio thread asks for SCHED_FIFO priority, as a host's would have. When
+// that isn't permitted (no CAP_SYS_NICE / rtprio limit, Windows) it runs at
+// normal priority and any preemption shows up as a deadline miss, so misses
+// are checked as a fraction of blocks rather than an absolute count.
+//
+// malloc/free and pthread_mutex_lock are intercepted on glibc; elsewhere
+// only C++ operator new/delete are counted and locks are not observed.
+//
+// Exit code 0 = all thresholds met, 1 = at least one exceeded.
+//==============================================================================
+namespace rt {
+    // Constant-initialised so touching it from inside malloc is safe
+    thread_local bool inAudioCallback = false;
+
+    std::atomic<long long> allocations    { 0 };
+    std::atomic<long long> frees          { 0 };
+    std::atomic<long long> mutexLocks     { 0 };
+    std::atomic<long long> contendedLocks { 0 };
+
+    inline void noteAlloc() noexcept { if (inAudioCallback) allocations.fetch_add (1, std::memory_order_relaxed); }
+    inline void noteFree()  noexcept { if (inAudioCallback) frees.fetch_add (1, std::memory_order_relaxed); }
+
+    struct AudioCallbackScope
+    {
+        AudioCallbackScope()  noexcept { inAudioCallback = true; }
+        ~AudioCallbackScope() noexcept { inAudioCallback = false; }
+    };
+
+    constexpr bool canObserveLocks =
+       #if defined (__GLIBC__)
+        true;
+       #else
+        false;
+       #endif
+}
+
+//==============================================================================
+#if defined (__GLIBC__)
+extern "C"
+{
+    void* __libc_malloc   (size_t);
+    void* __libc_calloc   (size_t, size_t);
+    void* __libc_realloc  (void*, size_t);
+    void* __libc_memalign (size_t, size_t);
+    void  __libc_free     (void*);
+
+    void* malloc (size_t size) noexcept                { rt::noteAlloc(); return __libc_malloc (size); }
+    void* calloc (size_t n, size_t size) noexcept      { rt::noteAlloc(); return __libc_calloc (n, size); }
+    void* realloc (void* p, size_t size) noexcept      { rt::noteAlloc(); return __libc_realloc (p, size); }
+    void* memalign (size_t align, size_t size) noexcept { rt::noteAlloc(); return __libc_memalign (align, size); }
+    void* aligned_alloc (size_t align, size_t size) noexcept { rt::noteAlloc(); return __libc_memalign (align, size); }
+
+    int posix_memalign (void** result, size_t align, size_t size) noexcept
+    {
+        rt::noteAlloc();
+        *result = __libc_memalign (align, size);
+        return *result != nullptr ? 0 : ENOMEM;
+    }
+
+    void free (void* p) noexcept
+    {
+        if (p != nullptr) rt::noteFree();
+        __libc_free (p);
+    }
+}
+
+// Resolved by a static initialiser; no function-local statics here, as their
+// guards may themselves take a mutex
+namespace rt {
+    using MutexFn = int (*) (pthread_mutex_t*);
+
+    MutexFn realMutexLock    = nullptr;
+    MutexFn realMutexTrylock = nullptr;
+
+    void resolveMutexFunctions() noexcept
+    {
+        realMutexLock    = (MutexFn) dlsym (RTLD_NEXT, "pthread_mutex_lock");
+        realMutexTrylock = (MutexFn) dlsym (RTLD_NEXT, "pthread_mutex_trylock");
+    }
+
+    [[maybe_unused]] const bool mutexFunctionsResolved = (resolveMutexFunctions(), true);
+}
+
+extern "C" int pthread_mutex_lock (pthread_mutex_t* m) noexcept
+{
+    if (rt::realMutexLock == nullptr)
+        rt::resolveMutexFunctions();
+
+    if (!rt::inAudioCallback)
+        return rt::realMutexLock (m);
+
+    rt::mutexLocks.fetch_add (1, std::memory_order_relaxed);
+
+    // Uncontended locks succeed here; anything else would have blocked the audio thread
+    if (rt::realMutexTrylock (m) == 0)
+        return 0;
+
+    rt::contendedLocks.fetch_add (1, std::memory_order_relaxed);
+    return rt::realMutexLock (m);
+}
+#else
+void* operator new (size_t size)
+{
+    rt::noteAlloc();
+    if (auto* p = std::malloc (size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[] (size_t size)
+{
+    rt::noteAlloc();
+    if (auto* p = std::malloc (size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete   (void* p) noexcept         { if (p != nullptr) rt::noteFree(); std::free (p); }
+void operator delete[] (void* p) noexcept         { if (p != nullptr) rt::noteFree(); std::free (p); }
+void operator delete   (void* p, size_t) noexcept { if (p != nullptr) rt::noteFree(); std::free (p); }
+void operator delete[] (void* p, size_t) noexcept { if (p != nullptr) rt::noteFree(); std::free (p); }
+#endif
+
+//==============================================================================
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        long long blocks               = 2000000;
+        long long warmupBlocks         = 1000;
+        int       maxBlockSize         = 64;
+        double    sampleRate           = 48000.0;
+        int       seed                 = 1234;
+
+        // Thresholds (-1 = not checked)
+        long long maxAllocations       = 0;
+        long long maxFrees             = 0;
+        long long maxMutexLocks        = -1; // juce::Synthesiser locks its own (uncontended) CriticalSection per render
+        long long maxContendedLocks    = 0;
+        long long maxDeadlineMisses    = -1;
+        double    maxDeadlineMissRatio = 0.001; // of timed blocks; absorbs the odd preemption or page fault
+        double    deadlineFraction     = 1.0; // of the block's real-time duration
+        double    maxBlockMicros       = -1.0;
+    };
+
+    Options parseOptions (const juce::ArgumentList& args)
+    {
+        Options o;
+
+        auto getInt = [&args] (const char* name, long long& value)
+        {
+            if (args.containsOption (name))
+                value = args.getValueForOption (name).getLargeIntValue();
+        };
+
+        auto getDouble = [&args] (const char* name, double& value)
+        {
+            if (args.containsOption (name))
+                value = args.getValueForOption (name).getDoubleValue();
+        };
+
+        long long maxBlock = o.maxBlockSize, seed = o.seed;
+
+        getInt    ("--blocks",              o.blocks);
+        getInt    ("--warmup",              o.warmupBlocks);
+        getInt    ("--max-block-size",      maxBlock);
+        getDouble ("--sample-rate",         o.sampleRate);
+        getInt    ("--seed",                seed);
+        getInt    ("--max-allocs",          o.maxAllocations);
+        getInt    ("--max-frees",           o.maxFrees);
+        getInt    ("--max-mutex-locks",     o.maxMutexLocks);
+        getInt    ("--max-contended-locks", o.maxContendedLocks);
+        getInt    ("--max-deadline-misses", o.maxDeadlineMisses);
+        getDouble ("--max-deadline-miss-ratio", o.maxDeadlineMissRatio);
+        getDouble ("--deadline-fraction",   o.deadlineFraction);
+        getDouble ("--max-block-us",        o.maxBlockMicros);
+
+        o.maxBlockSize = (int) juce::jlimit (1LL, 8192LL, maxBlock);
+        o.seed         = (int) seed;
+        return o;
+    }
+
+    void printUsage()
+    {
+        std::printf ("DarkSynthRealtimeStressTest [--option=value ...]\n"
+                     "  --blocks=N               blocks to render (2000000)\n"
+                     "  --warmup=N               initial blocks excluded from timing (1000)\n"
+                     "  --max-block-size=N       block sizes are random in [1, N] (64)\n"
+                     "  --sample-rate=HZ         (48000)\n"
+                     "  --seed=N                 (1234)\n"
+                     "Thresholds, -1 disables a check:\n"
+                     "  --max-allocs=N           audio-thread allocations (0)\n"
+                     "  --max-frees=N            audio-thread frees (0)\n"
+                     "  --max-mutex-locks=N      audio-thread mutex acquisitions (-1)\n"
+                     "  --max-contended-locks=N  audio-thread locks that had to wait (0)\n"
+                     "  --max-deadline-misses=N  blocks slower than their deadline (-1)\n"
+                     "  --max-deadline-miss-ratio=F\n"
+                     "                           fraction of blocks slower than their deadline (0.001)\n"
+                     "  --deadline-fraction=F    deadline as a fraction of block duration (1.0)\n"
+                     "  --max-block-us=US        worst-case block time (-1)\n");
+    }
+
+    // Random short MIDI messages: notes, releases, CCs, pitch bend, panics
+    void addMidiStorm (juce::MidiBuffer& midi, juce::Random& rng, int numSamples)
+    {
+        if (rng.nextFloat() > 0.3f)
+            return;
+
+        const int numEvents = 1 + rng.nextInt (16);
+        for (int i = 0; i < numEvents; ++i)
+        {
+            const int pos     = rng.nextInt (numSamples);
+            const int channel = 1 + rng.nextInt (2);
+            const int note    = 24 + rng.nextInt (72);
+            const int kind    = rng.nextInt (100);
+
+            if      (kind < 45) midi.addEvent (juce::MidiMessage::noteOn  (channel, note, (juce::uint8) (1 + rng.nextInt (127))), pos);
+            else if (kind < 85) midi.addEvent (juce::MidiMessage::noteOff (channel, note), pos);
+            else if (kind < 93) midi.addEvent (juce::MidiMessage::controllerEvent (channel, rng.nextInt (128), rng.nextInt (128)), pos);
+            else if (kind < 98) midi.addEvent (juce::MidiMessage::pitchWheel (channel, rng.nextInt (16384)), pos);
+            else                midi.addEvent (juce::MidiMessage::allNotesOff (channel), pos);
+        }
+    }
+
+    // Realtime scheduling for the calling thread; false if the OS refuses it
+    bool raiseToRealtimePriority() noexcept
+    {
+       #if ! JUCE_WINDOWS
+        sched_param param {};
+        param.sched_priority = (sched_get_priority_min (SCHED_FIFO) + sched_get_priority_max (SCHED_FIFO)) / 2;
+        return pthread_setschedparam (pthread_self(), SCHED_FIFO, &param) == 0;
+       #else
+        return false;
+       #endif
+    }
+
+    struct AudioStats
+    {
+        bool      realtimePriority = false;
+        long long blocks           = 0;
+        long long deadlineMisses   = 0;
+        double    worstMicros      = 0.0;
+        double    worstDeadlineUs  = 0.0; // deadline of the slowest block
+        double    totalMicros      = 0.0;
+    };
+
+    AudioStats runAudioThread (SynthPluginAudioProcessor& proc, const Options& o)
+    {
+        AudioStats stats;
+        stats.realtimePriority = raiseToRealtimePriority();
+
+        juce::Random rng (o.seed);
+
+        juce::AudioBuffer<float> buffer (2, o.maxBlockSize);
+        juce::MidiBuffer midi;
+        midi.ensureSize (8192);
+
+        for (long long b = 0; b < o.blocks; ++b)
+        {
+            // Host-side preparation, outside the measured callback
+            const int numSamples = 1 + rng.nextInt (o.maxBlockSize);
+            buffer.setSize (2, numSamples, false, false, true);
+            midi.clear();
+            addMidiStorm (midi, rng, numSamples);
+
+            auto start = Clock::now();
+            {
+                rt::AudioCallbackScope scope;
+                proc.processBlock (buffer, midi);
+            }
+            auto micros = std::chrono::duration<double, std::micro> (Clock::now() - start).count();
+
+            if (b < o.warmupBlocks)
+                continue;
+
+            const double deadline = o.deadlineFraction * 1.0e6 * numSamples / o.sampleRate;
+
+            ++stats.blocks;
+            stats.totalMicros += micros;
+
+            if (micros > deadline)
+                ++stats.deadlineMisses;
+
+            if (micros > stats.worstMicros)
+            {
+                stats.worstMicros     = micros;
+                stats.worstDeadlineUs = deadline;
+            }
+        }
+
+        return stats;
+    }
+
+    bool check (const char* what, double value, double limit)
+    {
+        const bool ok = limit < 0.0 || value <= limit;
+
+        if (limit < 0.0)
+            std::printf ("  %-28s %14.6g   (not checked)\n", what, value);
+        else
+            std::printf ("  %-28s %14.6g   limit %-10.6g %s\n", what, value, limit, ok ? "ok" : "FAIL");
+
+        return ok;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    juce::ArgumentList args (argc, argv);
+
+    if (args.containsOption ("--help|-h"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    const auto o = parseOptions (args);
+
+    SynthPluginAudioProcessor proc;
+    proc.setPlayConfigDetails (0, 2, o.sampleRate, o.maxBlockSize);
+    proc.prepareToPlay (o.sampleRate, o.maxBlockSize);
+
+    std::printf ("DarkSynth real-time stress test: %lld blocks of 1-%d samples at %.0f Hz (seed %d)\n",
+                 o.blocks, o.maxBlockSize, o.sampleRate, o.seed);
+
+    std::atomic<bool> running { true };
+
+    // Host automation: random parameters moved continuously
+    std::thread automation ([&]
+    {
+        juce::Random rng (o.seed + 1);
+        auto& params = proc.getParameters();
+
+        while (running.load())
+        {
+            if (auto* p = params[rng.nextInt (params.size())])
+                p->setValueNotifyingHost (rng.nextFloat());
+
+            std::this_thread::sleep_for (std::chrono::microseconds (50 + rng.nextInt (200)));
+        }
+    });
+
+    // Preset changes and state save/restore
+    std::thread control ([&]
+    {
+        juce::Random rng (o.seed + 2);
+        juce::MemoryBlock state;
+
+        while (running.load())
+        {
+            if (rng.nextBool())
+            {
+                proc.setCurrentProgram (rng.nextInt (proc.getNumPrograms()));
+            }
+            else
+            {
+                proc.getStateInformation (state);
+                proc.setStateInformation (state.getData(), (int) state.getSize());
+            }
+
+            std::this_thread::sleep_for (std::chrono::milliseconds (1 + rng.nextInt (5)));
+        }
+    });
+
+    AudioStats stats;
+    std::thread audio ([&] { stats = runAudioThread (proc, o); });
+
+    audio.join();
+    running = false;
+    automation.join();
+    control.join();
+
+    proc.releaseResources();
+
+    const double meanMicros = stats.blocks > 0 ? stats.totalMicros / (double) stats.blocks : 0.0;
+    const double missRatio  = stats.blocks > 0 ? (double) stats.deadlineMisses / (double) stats.blocks : 0.0;
+
+    std::printf ("\nTimed blocks: %lld   mean %.2f us   worst %.2f us (deadline %.2f us)\n",
+                 stats.blocks, meanMicros, stats.worstMicros, stats.worstDeadlineUs);
+
+    if (stats.realtimePriority)
+        std::printf ("Audio thread priority: realtime (SCHED_FIFO)\n\n");
+    else
+        std::printf ("Audio thread priority: normal (realtime scheduling not permitted here);\n"
+                     "deadline results include OS preemption and are indicative only\n\n");
+
+    bool pass = true;
+    pass &= check ("allocations", (double) rt::allocations.load(), (double) o.maxAllocations);
+    pass &= check ("frees",       (double) rt::frees.load(),       (double) o.maxFrees);
+
+    if (rt::canObserveLocks)
+    {
+        pass &= check ("mutex acquisitions", (double) rt::mutexLocks.load(),     (double) o.maxMutexLocks);
+        pass &= check ("contended locks",    (double) rt::contendedLocks.load(), (double) o.maxContendedLocks);
+    }
+    else
+    {
+        std::printf ("  %-28s   not observable on this platform\n", "mutex acquisitions");
+    }
+
+    pass &= check ("deadline misses",     (double) stats.deadlineMisses, (double) o.maxDeadlineMisses);
+    pass &= check ("deadline miss ratio", missRatio,                     o.maxDeadlineMissRatio);
+    pass &= check ("worst block (us)",    stats.worstMicros,             o.maxBlockMicros);
+
+    std::printf ("\n%s\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}